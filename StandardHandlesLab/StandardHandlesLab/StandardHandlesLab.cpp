@@ -10,331 +10,224 @@ int _tmain ( int argc , _TCHAR* argv [ ] )
 	int intRC		= ERROR_SUCCESS;
 	ForceIntoDEebugger;
 
-	LPTSTR lpPgmID	= ProgramIDFromArgV ( argv [ 0 ] ) ;
-
-	_tprintf ( 
-		FB_LoadString (
-			FB_LOOK_IN_THIS_EXE ,
-			IDS_BOJ ,
-			FB_FIRST_BUFFER_INDEX ,
-			FB_HIDE_LENGTH ) ,
+	LPCTSTR lpPgmID	= PI_Initialize ( argv [ 0 ] )->pvProgramID.lpText ;		// Computed once; never freed, because it was never allocated.
+	TA_MARK taMainMark = TA_GetMark ( ) ;							// Formatted messages are released as soon as they are printed.
+	BOOL fRelay = argc > SHL_ARG_SWITCH && _tcsicmp ( argv [ SHL_ARG_SWITCH ] , SHL_RELAY_SWITCH ) == 0 ;
+	FILE * lpfReport = fRelay ? stderr : stdout ;					// In relay mode, standard output carries the data, and nothing else.
+
+	_ftprintf (
+		lpfReport ,
+		SHL_STR_IDS_BOJ ,
 		lpPgmID ) ;
 
 	UINT uintInitialErrorMode = SetErrorMode ( SEM_NOGPFAULTERRORBOX | SEM_FAILCRITICALERRORS ) ;
-	_tprintf ( 
-		FB_LoadString (
-			FB_LOOK_IN_THIS_EXE ,
-			IDS_NEW_CRT_ERRORMODE ,
-			FB_FIRST_BUFFER_INDEX ,
-			FB_HIDE_LENGTH ) ,										// Format Control String (template), fed directly into _tprintf.
+	_ftprintf (
+		lpfReport ,
+		SHL_STR_IDS_NEW_CRT_ERRORMODE ,								// Format Control String (template), fed directly into _ftprintf.
 		uintInitialErrorMode ,										// Original:  Hexadecimal
 		uintInitialErrorMode ,										//            Decimal
 		SEM_NOGPFAULTERRORBOX | SEM_FAILCRITICALERRORS ,			// New Value: Hexadecimal
 		SEM_NOGPFAULTERRORBOX | SEM_FAILCRITICALERRORS );			//            Decimal
-	SetUnhandledExceptionFilter ( SHL_CrashHandler );				// From now on, SHL_CrashHandler gets all unhandled exceptions except buffer overruns and such.
 
-	if ( intRC = SHL_PerformTests ( ) )
+	if ( !CR_Install (												// From now on, CrashReporter gets all unhandled exceptions except buffer overruns and such.
+			lpPgmID ,												// LPCTSTR		plpProgramID
+			TA_Format ( SHL_CRASH_REPORT_FILE_NAME , lpPgmID ) ,	// LPCTSTR		plpReportFileName, which needn't outlive the call
+			g_showCrashDialog ) )									// const BOOL	pfContinueSearch
+	{
+		_ftprintf (
+			lpfReport ,
+			TEXT ( "%s" ) ,
+			TA_FormatSystemMessage (
+				CR_IsInstalled ( )									// Without a report file, or without everything else
+					? SHL_STR_IDS_ERRMSG_CR_INSTALL
+					: SHL_STR_IDS_ERRMSG_CR_NOT_INSTALLED ,
+				GetLastError ( ) ) );
+	}	// if ( !CR_Install ( lpPgmID , TA_Format ( SHL_CRASH_REPORT_FILE_NAME , lpPgmID ) , g_showCrashDialog ) )
+
+	TA_ReleaseToMark ( taMainMark ) ;
+
+	if ( intRC = SHL_PerformTests ( lpfReport ) )
+	{
+		_ftprintf (
+			lpfReport ,
+			TEXT ( "%s" ) ,
+			TA_FormatSystemMessage (
+				SHL_STR_IDS_ERRMSG_GETSTDHANDLE ,
+				intRC ) );
+		TA_ReleaseToMark ( taMainMark ) ;
+	}	// if ( intRC = SHL_PerformTests ( lpfReport ) )
+	else if ( fRelay )
 	{
-		_tprintf (
-			FB_FormatMessage ( 
-				FB_LoadString (
-					FB_LOOK_IN_THIS_EXE , 
-					IDS_ERRMSG_GETSTDHANDLE ,
-					FB_FIRST_BUFFER_INDEX ,
-					FB_HIDE_LENGTH ) ,
-				intRC ,
-				SCF2_HEXADECIMAL ) );
-	}	// if ( intRC = SHL_PerformTests ( ) )
+		SR_STATISTICS srStatistics ;
 
-	_tprintf (
-		FB_LoadString (
-			FB_LOOK_IN_THIS_EXE ,
-			IDS_EOJ ,
-			FB_FIRST_BUFFER_INDEX ,
-			FB_HIDE_LENGTH ) ,
+		if ( SR_Relay ( SR_AUTOMATIC , &srStatistics ) )
+		{
+			_ftprintf (
+				lpfReport ,
+				SHL_STR_IDS_MSG_RELAY_COMPLETE ,
+				( unsigned long long ) srStatistics.ullBytes ,
+				SR_MethodName ( srStatistics.enmMethod ) ,
+				( unsigned long long ) srStatistics.ullTransfers ,
+				( unsigned long ) srStatistics.dwFallbacks ) ;		// DWORD is an unsigned long only on Windows.
+		}	// TRUE (anticipated outcome) block, if ( SR_Relay ( SR_AUTOMATIC , &srStatistics ) )
+		else
+		{
+			intRC = GetLastError ( ) ;
+			_ftprintf (
+				lpfReport ,
+				TEXT ( "%s" ) ,
+				TA_FormatSystemMessage (
+					SHL_STR_IDS_ERRMSG_SR_RELAY ,
+					intRC ) );
+			TA_ReleaseToMark ( taMainMark ) ;
+		}	// FALSE (UNanticipated outcome) block, if ( SR_Relay ( SR_AUTOMATIC , &srStatistics ) )
+	}	// else if ( fRelay )
+
+	HP_DUMP ( lpfReport ) ;										// Compiles to nothing unless SHS_INSTRUMENTATION is defined.
+
+	_ftprintf (
+		lpfReport ,
+		SHL_STR_IDS_EOJ ,
 		lpPgmID ) ;
 	return intRC;
 }	// int _tmain(int argc, _TCHAR* argv[])
 
 
-LONG WINAPI SHL_CrashHandler
-(
-	EXCEPTION_POINTERS *	plpExceptionPtrs						// ExceptionInfo
-)
-{
-	_tprintf (
-		FB_LoadString (
-			FB_LOOK_IN_THIS_EXE ,
-			IDS_ERRMSG_UNHANDLED_EXCEPTION ,
-			FB_FIRST_BUFFER_INDEX ,
-			FB_HIDE_LENGTH ) ,										// Format Control String (template)
-		plpExceptionPtrs->ExceptionRecord->ExceptionCode ,			// Exception Code:		Hexadecimal
-		plpExceptionPtrs->ExceptionRecord->ExceptionCode ,			//						Decimal
-		plpExceptionPtrs->ExceptionRecord->ExceptionAddress ,		// Exception Address:	Hexadecimal
-		plpExceptionPtrs->ExceptionRecord->ExceptionAddress ) ;		//						Decimal
-	return g_showCrashDialog ? EXCEPTION_CONTINUE_SEARCH : EXCEPTION_EXECUTE_HANDLER ;
-}	// SHL_CrashHandler
-
-
-int __stdcall SHL_PerformTests ( )
+int __stdcall SHL_PerformTests ( FILE * plpfReport )
 {
-#define SHL_STDIN	ARRAY_FIRST_ELEMENT_P6C
-#define SHL_STDOUT	( SHL_STDIN  + ARRAY_NEXT_ELEMENT_P6C )
-#define SHL_STERR	( SHL_STDOUT + ARRAY_NEXT_ELEMENT_P6C )
 #define SHL_1ST_LBL	IDS_HANDLE_STDIN
 
-	static HANDLE hStdConsoleHandles [ ] =
-	{
-		NULL ,														// SHL_STDIN
-		NULL ,														// SHL_STDOUT
-		NULL														// SHL_STERR
-	};	// static HFILE hStdConsoleHandles [ ]
+	//	------------------------------------------------------------------------
+	//	One call to SHS_StandardHandleStates reports all three handles, target
+	//	names included, from the snapshot and the resolver's cache, in place of
+	//	a GetStdHandle, a GetConsoleMode, and a name lookup apiece.
+	//
+	//	The names go into one buffer in the calling thread's arena, which lives
+	//	until this routine returns.
+	//	------------------------------------------------------------------------
 
-	static DWORD dwStdConsoleHandleIDs [ ] =
-	{
-		STD_INPUT_HANDLE ,											// SHL_STDIN
-		STD_OUTPUT_HANDLE ,											// SHL_STDOUT
-		STD_ERROR_HANDLE											// SHL_STERR
-	};	// static DWORD dwStdConsoleHandleIDs [ ]
+	SHS_HANDLE_INFO ashsHandleInfo [ SHS_STANDARD_HANDLE_COUNT ] ;
+	TA_MARK taTestsMark = TA_GetMark ( ) ;
+	HP_ENTER ( HP_SHL_PERFORM_TESTS ) ;
 
-	static SHS_STANDARD_HANDLE ashsStandardHandleIDs [ ]
-	{
-		SHS_INPUT ,													// Value = 1, which corresponds to STD_INPUT_HANDLE
-		SHS_OUTPUT ,												// Value = 2, which corresponds to STD_OUTPUT_HANDLE
-		SHS_ERROR 													// Value = 3, which corresponds to STD_ERROR_HANDLE
-	};	// static SHS_STANDARD_HANDLE ashsStandardHandleIDs [ ]
+	LPTSTR rlpTargetFileNames = TA_Allocate ( SHS_STANDARD_HANDLE_COUNT * SHS_TARGET_MAX_TCHARS ) ;
+	DWORD dwAllocationStatus = rlpTargetFileNames ? ERROR_SUCCESS : GetLastError ( ) ;
 
-	DWORD dwModde = ZERO_P6C;
+	for ( UINT uintIndex = ARRAY_FIRST_ELEMENT_P6C;
+		       uintIndex < SHS_STANDARD_HANDLE_COUNT;
+		       uintIndex++ )
+	{	// Unless the unthinkable happens, and the arena is exhausted, each handle gets its own slice of the buffer.
+		ashsHandleInfo [ uintIndex ].lpTarget		= rlpTargetFileNames ? rlpTargetFileNames + uintIndex * SHS_TARGET_MAX_TCHARS : NULL ;
+		ashsHandleInfo [ uintIndex ].dwTargetTChars	= rlpTargetFileNames ? SHS_TARGET_MAX_TCHARS : ZERO_P6C ;
+	}	// for ( UINT uintIndex = ARRAY_FIRST_ELEMENT_P6C; uintIndex < SHS_STANDARD_HANDLE_COUNT; uintIndex++ )
 
-	LPTSTR lpHandleLabel = NULL;
-	LPTSTR lpHandleMessage = NULL;
-	LPTSTR lpTargetFileName = NULL;
+	if ( SHS_StandardHandleStates ( ashsHandleInfo , SHS_STANDARD_HANDLE_COUNT , SHS_INFO_RESOLVE_TARGETS ) != SHS_STANDARD_HANDLE_COUNT )
+	{
+		DWORD dwStatusCode = GetLastError ( );
+		TA_ReleaseToMark ( taTestsMark ) ;
+		HP_LEAVE ( HP_SHL_PERFORM_TESTS ) ;
+		return dwStatusCode;
+	}	// if ( SHS_StandardHandleStates ( ashsHandleInfo , SHS_STANDARD_HANDLE_COUNT , SHS_INFO_RESOLVE_TARGETS ) != SHS_STANDARD_HANDLE_COUNT )
 
 	for ( UINT uintIndex = ARRAY_FIRST_ELEMENT_P6C;
-		       uintIndex < sizeof ( hStdConsoleHandles ) / sizeof ( HFILE );
+		       uintIndex < SHS_STANDARD_HANDLE_COUNT;
 		       uintIndex++ )
 	{
-		lpHandleLabel = FB_LoadString (
-			FB_LOOK_IN_THIS_EXE ,
-			SHL_1ST_LBL + uintIndex ,
-			FB_FIRST_BUFFER_INDEX ,
-			FB_HIDE_LENGTH ) ;
-
-		if ( ( hStdConsoleHandles [ uintIndex ] = GetStdHandle ( dwStdConsoleHandleIDs [ uintIndex ] ) ) != INVALID_HANDLE_VALUE )
-		{
-			if ( GetConsoleMode ( hStdConsoleHandles [ uintIndex ] , &dwModde ) )
-			{
-				lpHandleMessage = FB_LoadString (
-					FB_LOOK_IN_THIS_EXE ,
-					IDS_MSG_HANDLE_IS_DEFAULT ,
-					FB_BUFFER_INDEX_1 ,
-					FB_HIDE_LENGTH );
-				lpTargetFileName = NULL;
-			}	// TRUE (The handle is attached to the console.) block, if ( GetConsoleMode ( hStdConsoleHandles [ uintIndex ] , &dwModde ) )
-			else
-			{
-				lpHandleMessage = FB_LoadString (
-					FB_LOOK_IN_THIS_EXE ,
-					IDS_MSG_HANDLE_IS_REDIRECTED ,
-					FB_BUFFER_INDEX_1 ,
-					FB_HIDE_LENGTH );
-				lpTargetFileName = SHL_GetRedirectionTarget ( hStdConsoleHandles [ uintIndex ] ) ;
-			}	// FALSE (The handle is redirected.) block, if ( GetConsoleMode ( hStdConsoleHandles [ uintIndex ] , &dwModde ) )
-
-			_tprintf (
-				lpHandleMessage ,									// Format Control String (template)
-				lpHandleLabel );									// Descriptive label.
-
-			SHS_HANDLE_STATE shsHandleState = SHS_StandardHandleState ( ashsStandardHandleIDs [ uintIndex ] );
-			
-			switch ( shsHandleState )
-			{
-				case SHS_ATTACHED:
-					_tprintf (
-						FB_LoadString (
-							FB_LOOK_IN_THIS_EXE ,
-							IDS_ATTACHED_PER_SHS_STANDARDHANDLESTATE ,
-							FB_BUFFER_INDEX_1 ,
-							FB_HIDE_LENGTH ) );
-					break;											// case SHS_ATTACHED
-
-				case SHS_REDIRECTED:
-					_tprintf (
-						FB_LoadString (
-							FB_LOOK_IN_THIS_EXE ,
-							IDS_REDIRECTED_PER_SHS_STANDARDHANDLESTATE ,
-							FB_BUFFER_INDEX_1 ,
-							FB_HIDE_LENGTH ) );
-					break;											// case SHS_REDIRECTED:
+		TA_MARK taIterationMark = TA_GetMark ( ) ;					// Everything below lives until the end of this iteration.
+		LPCTSTR lpHandleLabel = SHL_GetString ( SHL_1ST_LBL + uintIndex ) ;
 
-				default:
-					DWORD dwStatusCode = GetLastError ( );
-					_tprintf (
-						FB_LoadString (
-							FB_LOOK_IN_THIS_EXE ,
-							IDS_ERRMSG_STD_HANDLE_STATE ,
-							FB_BUFFER_INDEX_1 ,
-							FB_HIDE_LENGTH ) ,
-						dwStatusCode ,
-						dwStatusCode );
-					break;											// SHS_StandardHandleState reported an error.
-			}	// switch ( shsHandleState )
-
-			if ( lpTargetFileName )
-			{	// Unless the handle is redirected, lpTargetFileName is NULL.
-				_tprintf (
-					FB_LoadString (
-						FB_LOOK_IN_THIS_EXE ,
-						IDS_MSG_REDIRECTION_TARGET ,
-						FB_BUFFER_INDEX_2 ,
-						FB_HIDE_LENGTH ) ,
-					lpTargetFileName );
-			}	// if ( lpTargetFileName )
-		}	// TRUE (anticipated outcome) block, if ( ( hStdConsoleHandles [ uintIndex ] = GetStdHandle ( dwStdConsoleHandleIDs [ uintIndex ] ) ) != INVALID_HANDLE_VALUE )
-		else
+		switch ( ashsHandleInfo [ uintIndex ].enmState )
 		{
-			return GetLastError ( );
-		}	// FALSE (UNanticipated outcome) block, if ( ( hStdConsoleHandles [ uintIndex ] = GetStdHandle ( dwStdConsoleHandleIDs [ uintIndex ] ) ) != INVALID_HANDLE_VALUE )
-	}	// for ( UINT uintIndex = ARRAY_FIRST_ELEMENT_P6C; uintIndex < sizeof ( hStdConsoleHandle ) / sizeof ( HFILE ); uintIndex++ )
-
+			case SHS_ATTACHED:
+				_ftprintf (
+					plpfReport ,
+					SHL_STR_IDS_MSG_HANDLE_IS_DEFAULT ,				// Format Control String (template)
+					lpHandleLabel );								// Descriptive label.
+				_ftprintf (
+					plpfReport ,
+					SHL_STR_IDS_ATTACHED_PER_SHS_STANDARDHANDLESTATE );
+				break;												// case SHS_ATTACHED
+
+			case SHS_REDIRECTED:
+				_ftprintf (
+					plpfReport ,
+					SHL_STR_IDS_MSG_HANDLE_IS_REDIRECTED ,			// Format Control String (template)
+					lpHandleLabel );								// Descriptive label.
+				_ftprintf (
+					plpfReport ,
+					SHL_STR_IDS_REDIRECTED_PER_SHS_STANDARDHANDLESTATE );
+				_ftprintf (
+					plpfReport ,
+					SHL_STR_IDS_MSG_REDIRECTION_TARGET ,
+					SHL_DescribeRedirectionTarget (
+						&ashsHandleInfo [ uintIndex ] ,
+						dwAllocationStatus ) );
+				break;												// case SHS_REDIRECTED:
+
+			default:
+				if ( ashsHandleInfo [ uintIndex ].dwStatusCode == ERROR_INVALID_HANDLE )
+				{	// GetStdHandle returned NULL, because the process has no such handle.
+					_ftprintf (
+						plpfReport ,
+						TEXT ( "%s" ) ,
+						TA_FormatSystemMessage (
+							TA_Format (
+								SHL_STR_IDS_ERRMSG_HANDLE_IS_NULL ,
+								lpHandleLabel ) ,
+							ashsHandleInfo [ uintIndex ].dwStatusCode ) );
+				}	// TRUE (The handle is NULL.) block, if ( ashsHandleInfo [ uintIndex ].dwStatusCode == ERROR_INVALID_HANDLE )
+				else
+				{
+					_ftprintf (
+						plpfReport ,
+						SHL_STR_IDS_ERRMSG_STD_HANDLE_STATE ,
+						ashsHandleInfo [ uintIndex ].dwStatusCode ,
+						ashsHandleInfo [ uintIndex ].dwStatusCode );
+				}	// FALSE (SHS_StandardHandleStates reported some other error.) block, if ( ashsHandleInfo [ uintIndex ].dwStatusCode == ERROR_INVALID_HANDLE )
+				break;												// SHS_StandardHandleStates reported an error.
+		}	// switch ( ashsHandleInfo [ uintIndex ].enmState )
+
+		TA_ReleaseToMark ( taIterationMark ) ;
+	}	// for ( UINT uintIndex = ARRAY_FIRST_ELEMENT_P6C; uintIndex < SHS_STANDARD_HANDLE_COUNT; uintIndex++ )
+
+	TA_ReleaseToMark ( taTestsMark ) ;
+	HP_LEAVE ( HP_SHL_PERFORM_TESTS ) ;
 	return ERROR_SUCCESS ;
 }	// int __stdcall SHL_PerformTests
 
 
-LPTSTR __stdcall SHL_GetRedirectionTarget ( HANDLE phStdHandle )
+LPCTSTR __stdcall SHL_DescribeRedirectionTarget
+(
+	const SHS_HANDLE_INFO *	pshsHandleInfo ,
+	const DWORD				pdwAllocationStatus
+)
 {
-	if ( phStdHandle )
+	//	------------------------------------------------------------------------
+	//	Return the name that SHS_StandardHandleStates resolved, or a message
+	//	that says why there isn't one. A message is formatted in the calling
+	//	thread's arena, and lives until the caller releases its mark.
+	//	------------------------------------------------------------------------
+
+	if ( pshsHandleInfo->lpTarget == NULL )
+	{	// The arena had no room for the names.
+		return TA_FormatSystemMessage (
+			SHL_STR_IDS_ERRMSG_GETLPRESOURCEBUFFER ,
+			pdwAllocationStatus );
+	}	// if ( pshsHandleInfo->lpTarget == NULL )
+
+	if ( pshsHandleInfo->lpTarget [ ARRAY_FIRST_ELEMENT_P6C ] )
+	{	// A truncated name is better than none.
+		return pshsHandleInfo->lpTarget;
+	}	// if ( pshsHandleInfo->lpTarget [ ARRAY_FIRST_ELEMENT_P6C ] )
+
+	if ( pshsHandleInfo->dwTargetStatus == SHS_ERROR_TARGET_UNSUPPORTED )
 	{
-		/*
-			--------------------------------------------------------------------
-			DWORD WINAPI GetFinalPathNameByHandle(
-				_In_  HANDLE hFile,
-				_Out_ LPTSTR lpszFilePath,
-				_In_  DWORD  cchFilePath,
-				_In_  DWORD  dwFlags
-			);
-
-			This function has ANSI and Unicode (wide character) implementations,
-			differentiated by the usual name decorations.
-			--------------------------------------------------------------------
-		*/
-
-		typedef DWORD ( WINAPI* tGetFinalPathNameByHandle )( HANDLE , LPTSTR , DWORD , DWORD );
-
-		RTL_OSVERSIONINFOEXW osvStruct;
-		
-		if ( SHL_GetOsVersion ( &osvStruct ) )
-		{
-			if ( osvStruct.dwMajorVersion >= 6 )
-			{
-				if ( LPSFSBUF rlpTargetFileName = FB_GetlpResourceBuffer ( FB_BUFFER_INDEX_3 ) )
-				{	// Unless the unthinkable happens, and FB_GetlpResourceBuffer fails... 
-					if ( HMODULE hKernel32 = GetModuleHandle ( L"Kernel32.dll" ) )
-					{
-						if ( tGetFinalPathNameByHandle faddrGetFinalPathNameByHandle = ( tGetFinalPathNameByHandle ) GetProcAddress ( hKernel32 , "GetFinalPathNameByHandleW" ) )
-						{
-							if ( DWORD dwFnLen = faddrGetFinalPathNameByHandle (
-								phStdHandle ,									// _In_  HANDLE hFile
-								( LPWSTR ) rlpTargetFileName ,					// _Out_ LPTSTR lpszFilePath
-								FB_GetResourceBufferTChars ( ) ,				// _In_  DWORD  cchFilePath
-								FILE_NAME_NORMALIZED ) )						// _In_  DWORD  dwFlags
-							{
-								return ( LPTSTR ) rlpTargetFileName;
-							}	// TRUE (anticipated outcome) block, if ( DWORD dwFnLen = faddrGetFinalPathNameByHandle ( phStdHandle , ( LPWSTR ) rlpTargetFileName , FB_GetResourceBufferTChars ( ) , FILE_NAME_NORMALIZED ) )
-							else
-							{
-								return FB_FormatMessage (
-									FB_LoadString (
-										FB_LOOK_IN_THIS_EXE ,
-										IDS_ERRMSG_GETFILENAMEBYHANDLE ,
-										FB_FIRST_BUFFER_INDEX ,
-										FB_HIDE_LENGTH ) ,
-									GetLastError ( ) ,
-									SCF2_HEXADECIMAL );
-							}	// FALSE (UNanticipated outcome) block, if ( DWORD dwFnLen = faddrGetFinalPathNameByHandle ( phStdHandle , ( LPWSTR ) rlpTargetFileName , FB_GetResourceBufferTChars ( ) , FILE_NAME_NORMALIZED ) )
-						}	// TRUE (anticipated outcome) block, if ( tGetFinalPathNameByHandle faddrGetFinalPathNameByHandle = ( tGetFinalPathNameByHandle ) GetProcAddress ( hKernel32 , "GetFinalPathNameByHandleW" ) )
-						else
-						{
-							return FB_FormatMessage (
-								FB_LoadString (
-									FB_LOOK_IN_THIS_EXE ,
-									IDS_ERRMSG_GETPROCADDRESS ,
-									FB_FIRST_BUFFER_INDEX ,
-									FB_HIDE_LENGTH ) ,
-								GetLastError ( ) ,
-								SCF2_HEXADECIMAL );
-						}	// FALSE (UNanticipated outcome) block, if ( tGetFinalPathNameByHandle faddrGetFinalPathNameByHandle = ( tGetFinalPathNameByHandle ) GetProcAddress ( hKernel32 , "GetFinalPathNameByHandleW" ) )
-					}	// TRUE (anticipated outcome) block, if ( HMODULE hKernel32 = GetModuleHandle ( L"Kernel32.dll" ) )
-					else
-					{
-						return FB_FormatMessage (
-							FB_LoadString (
-								FB_LOOK_IN_THIS_EXE ,
-								IDS_ERRMSG_GETMODULEHANDLE ,
-								FB_FIRST_BUFFER_INDEX ,
-								FB_HIDE_LENGTH ) ,
-							GetLastError ( ) ,
-							SCF2_HEXADECIMAL );
-					}	// FALSE (UNanticipated outcome) block, if ( HMODULE hKernel32 = GetModuleHandle ( L"Kernel32.dll" ) )
-				}	// TRUE (anticipated outcome) block, if ( LPSFSBUF rlpTargetFileName = FB_GetlpResourceBuffer ( FB_BUFFER_INDEX_3 ) )
-				else
-				{
-					return FB_FormatMessage (
-						FB_LoadString (
-							FB_LOOK_IN_THIS_EXE ,
-							IDS_ERRMSG_GETLPRESOURCEBUFFER ,
-							FB_FIRST_BUFFER_INDEX ,
-							FB_HIDE_LENGTH ) ,
-						GetLastError ( ) ,
-						SCF2_HEXADECIMAL );
-				}	// FALSE (UNanticipated outcome) block, if ( LPSFSBUF rlpTargetFileName = FB_GetlpResourceBuffer ( FB_BUFFER_INDEX_3 ) )
-			}	// TRUE (anticipated outcome) block, if ( osvStruct.dwMajorVersion >= 6 )
-			else
-			{
-				return FB_LoadString (
-					FB_LOOK_IN_THIS_EXE ,
-					IDS_ERRMSG_UNSUPPORTED_FEATURE ,
-					FB_FIRST_BUFFER_INDEX ,
-					FB_HIDE_LENGTH );
-			}	// FALSE (UNanticipated outcome) block, if ( osvStruct.dwMajorVersion >= 6 )
-		}	// TRUE (anticipated outcome) block, if ( GetVersionEx ( &osvStruct ) )
-		else
-		{
-			return FB_FormatMessage (
-				FB_LoadString (
-					FB_LOOK_IN_THIS_EXE ,
-					IDS_ERRMSG_GETVERSIONINFOEX ,
-					FB_FIRST_BUFFER_INDEX ,
-					FB_HIDE_LENGTH ) ,
-				GetLastError ( ) ,
-				SCF2_HEXADECIMAL );
-		}	// FALSE (UNanticipated outcome) block, if ( GetVersionEx ( &osvStruct ) )
-	}	// TRUE (anticipated outcome) block, if ( phStdHandle )
+		return SHL_STR_IDS_ERRMSG_UNSUPPORTED_FEATURE;
+	}	// TRUE (The platform cannot name the target.) block, if ( pshsHandleInfo->dwTargetStatus == SHS_ERROR_TARGET_UNSUPPORTED )
 	else
 	{
-		return FB_LoadString (
-			FB_LOOK_IN_THIS_EXE , 
-			IDS_ERRMSG_HANDLE_IS_NULL , 
-			FB_BUFFER_INDEX_4 , 
-			FB_HIDE_LENGTH );
-	}	// FALSE (UNanticipated outcome) block, if ( phStdHandle )
-}	// LPTSTR __stdcall SHL_GetRedirectionTarget
-
-
-BOOL __stdcall SHL_GetOsVersion ( RTL_OSVERSIONINFOEXW* pk_OsVer )
-{
-	// RTL_OSVERSIONINFOEXW is defined in winnt.h.
-	typedef LONG ( WINAPI* tRtlGetVersion )( RTL_OSVERSIONINFOEXW* );
-
-	memset ( pk_OsVer ,												// Starting address
-		     0 ,													// Initialization constant
-			 sizeof ( RTL_OSVERSIONINFOEXW ) );						// Bytes to initialize
-	pk_OsVer->dwOSVersionInfoSize = sizeof ( RTL_OSVERSIONINFOEXW );
-
-	HMODULE hNtDll = GetModuleHandleW ( L"ntdll.dll" );				// ntdll.dll is already loaded.
-
-	if ( tRtlGetVersion fRtlGetVersion = ( tRtlGetVersion ) GetProcAddress ( hNtDll , "RtlGetVersion" ) )
-		return ( fRtlGetVersion ( pk_OsVer ) ) == ERROR_SUCCESS;
-	else
-		return FALSE;												// This will never happen, since all processes load ntdll.dll.
-}	// BOOL __stdcall SHL_GetOsVersion
\ No newline at end of file
+		return TA_FormatSystemMessage (
+			SHL_STR_IDS_ERRMSG_GETFILENAMEBYHANDLE ,
+			pshsHandleInfo->dwTargetStatus );
+	}	// FALSE (UNanticipated outcome) block, if ( pshsHandleInfo->dwTargetStatus == SHS_ERROR_TARGET_UNSUPPORTED )
+}	// LPCTSTR __stdcall SHL_DescribeRedirectionTarget